@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "containers.h"
+
+// Сравнение времени обхода списков до и после linearize(), без программной
+// подкачки и с ней.
+// Перед заполнением списка куча "перемешивается": блоки размера узла
+// освобождаются в случайном порядке, и аллокатор (glibc берет освобожденные
+// мелкие блоки в порядке LIFO) раздает узлы по случайным адресам,
+// как после долгой работы со вставками и удалениями.
+
+// Размер запроса, попадающий в тот же класс аллокатора, что и узлы списков
+static const std::size_t kNodeBytes = sizeof(int) + 2 * sizeof(void*);
+
+// Освобождение blocks.size() блоков размера узла в случайном порядке.
+// Массив указателей должен жить, пока список не заполнен: освобождение большого
+// блока кучи заставляет glibc склеить свободные мелкие блоки обратно по порядку.
+static void scatterHeap(std::vector<void*>& blocks) {
+    for (void*& p : blocks) {
+        p = std::malloc(kNodeBytes);
+    }
+    std::shuffle(blocks.begin(), blocks.end(), std::mt19937(42));
+    for (void* p : blocks) {
+        std::free(p);
+    }
+}
+
+// Время в миллисекундах
+template <class F>
+static long long measureMs(F f) {
+    auto t0 = std::chrono::steady_clock::now();
+    f();
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count();
+}
+
+// Обход итератором с программной подкачкой: второй указатель идет на
+// kPrefetchDistance узлов впереди и подкачивает свой узел. Адрес узла впереди
+// известен только после загрузки предыдущего, поэтому выигрыша ждать не стоит —
+// замер это проверяет.
+static const int kPrefetchDistance = 4;
+
+template <class List>
+static long long scanPrefetch(List& list) {
+    long long sum = 0;
+    auto ahead = list.begin().ptr;
+    for (int i = 0; i < kPrefetchDistance && ahead != nullptr; ++i) {
+        ahead = ahead->next;
+    }
+    for (auto it = list.begin(); it != list.end(); ++it) {
+        if (ahead != nullptr) {
+            LAB3_PREFETCH(ahead);
+            ahead = ahead->next;
+        }
+        sum += it.get();
+    }
+    return sum;
+}
+
+// Обход итератором без подкачки и с ней, один полный проход operator[] до последнего элемента
+template <class List>
+static void scan(List& list, const char* label) {
+    long long sum = 0;
+    long long iterMs = measureMs([&] {
+        for (auto it = list.begin(); it != list.end(); ++it) {
+            sum += it.get();
+        }
+    });
+    long long prefetchSum = 0;
+    long long prefetchMs = measureMs([&] {
+        prefetchSum = scanPrefetch(list);
+    });
+    volatile int last = 0;
+    long long indexMs = measureMs([&] {
+        last = list[list.getSize() - 1];
+    });
+    std::cout << "  " << label << ": итератор " << iterMs << " мс, с подкачкой " << prefetchMs
+              << " мс, operator[] " << indexMs << " мс (сумма " << sum
+              << (sum == prefetchSum ? "" : ", РАСХОЖДЕНИЕ") << ", последний " << last << ")" << std::endl;
+}
+
+template <class List>
+static void bench(const char* name, int count) {
+    std::cout << name << ", узлов: " << count << std::endl;
+    List list;
+    {
+        std::vector<void*> blocks(static_cast<std::size_t>(count));
+        scatterHeap(blocks);
+        for (int i = count - 1; i >= 0; --i) {
+            list.push_front(i); // push_front — O(1) для обоих списков
+        }
+    }
+    scan(list, "до linearize()");
+    long long linMs = measureMs([&] {
+        list.linearize();
+    });
+    std::cout << "  linearize(): " << linMs << " мс" << std::endl;
+    scan(list, "после linearize()");
+}
+
+int main(int argc, char** argv) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    if (count <= 0) {
+        std::cerr << "Использование: lab3_bench [число узлов]" << std::endl;
+        return 2;
+    }
+    bench<DoubleLinkedList>("DoubleLinkedList", count);
+    bench<SinglyLinkedList>("SinglyLinkedList", count);
+    return 0;
+}
@@ -0,0 +1,1303 @@
+#pragma once
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <utility>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include "trace.h"
+
+// Большие буферы на Linux выделяются через mmap и растут через mremap
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define LAB3_HAVE_MREMAP 1
+#endif
+
+// Программная подкачка памяти (отключается через LAB3_NO_PREFETCH)
+#if defined(LAB3_NO_PREFETCH)
+#define LAB3_PREFETCH(p) ((void)0)
+#elif defined(__GNUC__) || defined(__clang__)
+#define LAB3_PREFETCH(p) __builtin_prefetch(p)
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <xmmintrin.h>
+#define LAB3_PREFETCH(p) _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0)
+#else
+#define LAB3_PREFETCH(p) ((void)0)
+#endif
+
+//Последовательный контейнер 
+struct ConsistentContainer {
+    // Каким путем была получена текущая память
+    enum class AllocPath {
+        Heap,   // Выровненный operator new[] с копированием элементов
+        Mmap,   // Новое анонимное отображение (переход с кучи, с копированием)
+        Mremap  // Ядро переотобразило страницы, копирования нет
+    };
+
+    static const std::size_t kAlignment = 64; // Выравнивание под SIMD-загрузки
+    static const std::size_t kDefaultHugeThreshold = 4u << 20; // 4 МБ
+    // Сколько старых элементов переносит один push_back при постепенном росте.
+    // При росте в 1.5 раза новых мест не меньше maxsize / 2 с округлением вниз;
+    // 4 элементов хватает при любом maxsize, включая малые (3 -> 4), чтобы перенос
+    // закончился раньше, чем заполнится новый буфер.
+    static const int kMigrateStep = 4;
+
+    int* data; // Указатель на массив 
+    int size; // Текущее количество элементов
+    int maxsize; // Максимальный размер массива
+    bool mapped; // Память получена через mmap, а не из кучи
+    std::size_t mappedBytes; // Длина отображения (кратна размеру страницы)
+    std::size_t hugeThreshold; // Начиная с этого размера в байтах используется mmap
+    AllocPath lastPath; // Путь, выбранный при последнем перераспределении
+    TraceRecorder* trace; // Запись операций в трассу, nullptr если не ведется
+    bool incremental; // Постепенный перенос элементов при росте
+    int* oldData; // Старый буфер, пока перенос не закончен, иначе nullptr
+    bool oldMapped; // Старый буфер получен через mmap
+    std::size_t oldMappedBytes; // Длина старого отображения
+    int oldSize; // Сколько элементов было в старом буфере
+    int migrated; // Элементы [0, migrated) уже перенесены в data
+    std::size_t oldReleased; // Сколько байт начала старого отображения уже возвращено системе
+
+    ConsistentContainer()
+    : data(nullptr), size(0), maxsize(0), mapped(false), mappedBytes(0),
+      hugeThreshold(kDefaultHugeThreshold), lastPath(AllocPath::Heap), trace(nullptr),
+      incremental(false), oldData(nullptr), oldMapped(false), oldMappedBytes(0),
+      oldSize(0), migrated(0), oldReleased(0) {}
+    
+    // Перемещающий конструктор
+    ConsistentContainer(ConsistentContainer&& rvalue) noexcept
+    : data(std::move(rvalue.data)), size(rvalue.size), maxsize(rvalue.maxsize),
+      mapped(rvalue.mapped), mappedBytes(rvalue.mappedBytes),
+      hugeThreshold(rvalue.hugeThreshold), lastPath(rvalue.lastPath), trace(rvalue.trace),
+      incremental(rvalue.incremental), oldData(rvalue.oldData), oldMapped(rvalue.oldMapped),
+      oldMappedBytes(rvalue.oldMappedBytes), oldSize(rvalue.oldSize), migrated(rvalue.migrated),
+      oldReleased(rvalue.oldReleased) {
+        rvalue.data = nullptr; // Освобождаем указатель у другого объекта
+        rvalue.size = 0;
+        rvalue.maxsize = 0;
+        rvalue.mapped = false;
+        rvalue.mappedBytes = 0;
+        rvalue.trace = nullptr;
+        rvalue.oldData = nullptr;
+        rvalue.oldMapped = false;
+        rvalue.oldMappedBytes = 0;
+        rvalue.oldSize = 0;
+        rvalue.migrated = 0;
+        rvalue.oldReleased = 0;
+    }
+
+    // Перемещающий оператор присваивания
+    ConsistentContainer& operator=(ConsistentContainer&& rvalue) noexcept {
+        if (this != &rvalue) { 
+        releaseData(); // Освобождение текущих ресурсов
+        releaseOld();
+        data = rvalue.data;
+        size = rvalue.size;
+        maxsize = rvalue.maxsize;
+        mapped = rvalue.mapped;
+        mappedBytes = rvalue.mappedBytes;
+        hugeThreshold = rvalue.hugeThreshold;
+        lastPath = rvalue.lastPath;
+        trace = rvalue.trace;
+        incremental = rvalue.incremental;
+        oldData = rvalue.oldData;
+        oldMapped = rvalue.oldMapped;
+        oldMappedBytes = rvalue.oldMappedBytes;
+        oldSize = rvalue.oldSize;
+        migrated = rvalue.migrated;
+        oldReleased = rvalue.oldReleased;
+        rvalue.data = nullptr; // Освобождаем указатель у другого объекта
+        rvalue.size = 0;
+        rvalue.maxsize = 0;
+        rvalue.mapped = false;
+        rvalue.mappedBytes = 0;
+        rvalue.trace = nullptr;
+        rvalue.oldData = nullptr;
+        rvalue.oldMapped = false;
+        rvalue.oldMappedBytes = 0;
+        rvalue.oldSize = 0;
+        rvalue.migrated = 0;
+        rvalue.oldReleased = 0;
+        }
+        return *this;
+    }
+
+    // Выделение выровненной памяти из кучи
+    static int* allocHeap(int capacity) {
+        return static_cast<int*>(::operator new[](
+            static_cast<std::size_t>(capacity) * sizeof(int), std::align_val_t(kAlignment)));
+    }
+
+    // Освобождение буфера с учетом того, откуда он был получен
+    static void freeStorage(int* p, bool isMapped, std::size_t bytes) {
+        if (p == nullptr) {
+            return;
+        }
+#ifdef LAB3_HAVE_MREMAP
+        if (isMapped) {
+            munmap(p, bytes);
+            return;
+        }
+#endif
+        (void)isMapped;
+        (void)bytes;
+        ::operator delete[](p, std::align_val_t(kAlignment));
+    }
+
+    // Освобождение текущего буфера
+    void releaseData() {
+        freeStorage(data, mapped, mappedBytes);
+        data = nullptr;
+        mapped = false;
+        mappedBytes = 0;
+    }
+
+#ifdef LAB3_HAVE_MREMAP
+    static std::size_t pageSize() {
+        return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+
+    // Освобождение старого буфера после переноса (кроме уже возвращенных страниц)
+    void releaseOld() {
+        if (oldData == nullptr) {
+            return;
+        }
+        if (!oldMapped || oldMappedBytes > oldReleased) {
+            freeStorage(reinterpret_cast<int*>(reinterpret_cast<char*>(oldData) + oldReleased),
+                        oldMapped, oldMappedBytes - oldReleased);
+        }
+        oldData = nullptr;
+        oldMapped = false;
+        oldMappedBytes = 0;
+        oldSize = 0;
+        migrated = 0;
+        oldReleased = 0;
+    }
+
+    // Текущий буфер откладывается как старый, элементы из него переносятся позже
+    void stashOld(int kept) {
+        oldData = data;
+        oldMapped = mapped;
+        oldMappedBytes = mappedBytes;
+        oldSize = kept;
+        migrated = 0;
+        oldReleased = 0;
+        data = nullptr;
+        mapped = false;
+        mappedBytes = 0;
+        if (oldSize == 0) {
+            releaseOld();
+        }
+    }
+
+    // Перенос не более kMigrateStep элементов из старого буфера
+    void migrateStep() {
+        if (oldData == nullptr) {
+            return;
+        }
+        int end = migrated + kMigrateStep < oldSize ? migrated + kMigrateStep : oldSize;
+        for (; migrated < end; ++migrated) {
+            data[migrated] = oldData[migrated];
+        }
+        if (migrated == oldSize) {
+            releaseOld();
+            return;
+        }
+#ifdef LAB3_HAVE_MREMAP
+        // Перенесенное начало отображения отдается системе постранично, чтобы
+        // последний шаг переноса не освобождал весь старый буфер за один вызов
+        if (oldMapped) {
+            std::size_t page = pageSize();
+            std::size_t done = static_cast<std::size_t>(migrated) * sizeof(int) / page * page;
+            if (done > oldReleased) {
+                munmap(reinterpret_cast<char*>(oldData) + oldReleased, done - oldReleased);
+                oldReleased = done;
+            }
+        }
+#endif
+    }
+
+    // Завершение переноса целиком (для операций, которые и так O(n))
+    void completeMigration() {
+        if (oldData == nullptr) {
+            return;
+        }
+        for (; migrated < oldSize; ++migrated) {
+            data[migrated] = oldData[migrated];
+        }
+        releaseOld();
+    }
+
+    // Ячейка элемента с учетом незавершенного переноса
+    int& slot(int index) {
+        if (oldData != nullptr && index >= migrated && index < oldSize) {
+            return oldData[index];
+        }
+        return data[index];
+    }
+
+    const int& slot(int index) const {
+        if (oldData != nullptr && index >= migrated && index < oldSize) {
+            return oldData[index];
+        }
+        return data[index];
+    }
+
+    // Перераспределение памяти под newmaxsize элементов.
+    // При deferCopy элементы не копируются, а переносятся постепенно.
+    void reallocate(int newmaxsize, bool deferCopy = false) {
+        int kept = size < newmaxsize ? size : newmaxsize;
+#ifdef LAB3_HAVE_MREMAP
+        std::size_t bytes = static_cast<std::size_t>(newmaxsize) * sizeof(int);
+        // Пустой буфер всегда из кучи: mremap не принимает длину 0.
+        // При постепенном росте буферы от страницы и больше тоже берутся через mmap,
+        // чтобы старый буфер можно было освобождать постранично (см. migrateStep)
+        std::size_t page = pageSize();
+        if (newmaxsize > 0 && (bytes >= hugeThreshold || (deferCopy && bytes >= page))) {
+            std::size_t newBytes = (bytes + page - 1) / page * page;
+            void* p;
+            if (mapped && !deferCopy) {
+                // Ядро переносит страницы само, элементы не копируются
+                p = mremap(data, mappedBytes, newBytes, MREMAP_MAYMOVE);
+                if (p == MAP_FAILED) {
+                    throw std::bad_alloc();
+                }
+                lastPath = AllocPath::Mremap;
+            } else {
+                p = mmap(nullptr, newBytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (p == MAP_FAILED) {
+                    throw std::bad_alloc();
+                }
+                int* newData = static_cast<int*>(p);
+                if (deferCopy) {
+                    stashOld(kept);
+                } else {
+                    for (int i = 0; i < kept; ++i) {
+                        newData[i] = data[i]; // Последнее копирование при переходе с кучи
+                    }
+                    releaseData();
+                }
+                lastPath = AllocPath::Mmap;
+            }
+#ifdef MADV_HUGEPAGE
+            // Подсказка, ошибка не критична. При постепенном росте не дается:
+            // первое касание огромной страницы обнуляет сразу 2 МБ
+            if (!deferCopy) {
+                madvise(p, newBytes, MADV_HUGEPAGE);
+            }
+#endif
+            data = static_cast<int*>(p); // Отображение выровнено по странице
+            mapped = true;
+            mappedBytes = newBytes;
+            maxsize = static_cast<int>(newBytes / sizeof(int));
+            return;
+        }
+#endif
+        int* newData = allocHeap(newmaxsize);
+        if (deferCopy) {
+            stashOld(kept);
+        } else {
+            for (int i = 0; i < kept; ++i) {
+                newData[i] = data[i]; // Копируем старые данные в новую память
+            }
+            releaseData();
+        }
+        data = newData; // Перенаправляем указатель на новую память
+        maxsize = newmaxsize;
+        lastPath = AllocPath::Heap;
+    }
+
+    // Функция для увеличения емкости.
+    // deferCopy передает только push_back: остальные вызывающие сразу двигают
+    // элементы по data и должны получить буфер с уже скопированными данными.
+    void moresize(bool deferCopy = false) {
+        completeMigration(); // Перенос с прошлого роста должен быть завершен
+        int newmaxsize = maxsize == 0 ? 1 : static_cast<int>(maxsize * 1.5); 
+        if (newmaxsize <= maxsize) {
+            newmaxsize = maxsize + 1; // 1 * 1.5 округляется обратно до 1
+        }
+        reallocate(newmaxsize, deferCopy);
+    }
+
+    // Функция для уменьшения емкости до фактического размера
+    void shrinkToFit() {
+        completeMigration();
+        reallocate(size);
+    }
+
+    // Постепенный рост: moresize() только выделяет новый буфер, а старые элементы
+    // переносятся по kMigrateStep за каждый следующий push_back. Худшее время push_back
+    // O(1), а не O(n) на вызове, который расширяет буфер; operator[] и итератор лишь
+    // выбирают нужный буфер и ничего не переносят, поэтому ссылки, полученные через них,
+    // остаются действительными до ближайшего push_back, как и без этого режима.
+    // Ограничения: границу O(1) дает постраничное освобождение через munmap, оно есть
+    // только на Linux; в остальных системах и при первом росте после включения режима
+    // на большом буфере из кучи старый буфер освобождается целиком одним вызовом.
+    void setIncrementalGrowth(bool enabled) {
+        if (!enabled) {
+            completeMigration();
+        }
+        incremental = enabled;
+    }
+
+    bool isIncrementalGrowth() const {
+        return incremental;
+    }
+
+    // Идет ли перенос элементов из старого буфера
+    bool isMigrating() const {
+        return oldData != nullptr;
+    }
+
+    // Порог в байтах, начиная с которого память берется через mmap
+    void setHugeThreshold(std::size_t bytes) {
+        hugeThreshold = bytes;
+    }
+
+    std::size_t getHugeThreshold() const {
+        return hugeThreshold;
+    }
+
+    // Путь, выбранный при последнем росте или сжатии
+    AllocPath getAllocPath() const {
+        return lastPath;
+    }
+
+    bool isMapped() const {
+        return mapped;
+    }
+
+    // Подключение записи трассы (nullptr отключает запись).
+    // Текущее содержимое записывается как push_back, чтобы воспроизведение
+    // начиналось с того же состояния.
+    void setTrace(TraceRecorder* recorder) {
+        trace = recorder;
+        if (trace) {
+            for (int i = 0; i < size; ++i) {
+                trace->record(TraceOp::PushBack, 0, slot(i));
+            }
+        }
+    }
+
+    // Добавление элемента в конец
+    void push_back(int value) {
+        if (trace) {
+            trace->record(TraceOp::PushBack, 0, value);
+        }
+        if (size == maxsize) {
+            moresize(incremental); // Изменяем размер, если емкость заполнена
+        }
+        data[size++] = value; // Добавляем элемент и увеличиваем размер
+        migrateStep();
+    }
+    // Добавление элемента в начало
+    void push_front(int value) {
+        if (trace) {
+            trace->record(TraceOp::PushFront, 0, value);
+        }
+        completeMigration(); // Сдвиг и так O(n)
+        if (size == maxsize) {
+            moresize(); // Изменяем размер, если емкость заполнена
+        }
+        // Сдвигаем все элементы на один вправо
+        for (int i = size; i > 0; --i) {
+            data[i] = data[i - 1];
+        }
+        data[0] = value; // Вставляем новый элемент в начало
+        ++size;
+    }
+
+    // Добавление элемента в указанный индекс
+    void insert(int index, int value) {
+        if (index < 0 || index > size) {
+            throw std::out_of_range("Индекс вне диапазона"); // Исключение для недопустимого индекса
+        }
+        if (trace) {
+            trace->record(TraceOp::Insert, index, value);
+        }
+        completeMigration(); // Сдвиг и так O(n)
+        if (size == maxsize) {
+            moresize(); // Изменяем размер, если емкость заполнена
+        }
+        // Сдвигаем элементы вправо, начиная с указанного индекса
+        for (int i = size; i > index; --i) {
+            data[i] = data[i - 1];
+        }
+        data[index] = value; // Вставляем значение в указанный индекс
+        ++size;
+    }
+
+    // Удаление элемента по индексу 
+    void erase(int index) { 
+        if (index < 0 || index >= size) { 
+            throw std::out_of_range("Индекс вне диапазона"); // Исключение для недопустимого индекса 
+        } 
+        if (trace) {
+            trace->record(TraceOp::Erase, index, 0);
+        }
+        completeMigration(); // Сдвиг и так O(n)
+        for (int i = index; i < size - 1; ++i) { 
+            data[i] = data[i + 1]; // Сдвинаем элементы влево 
+        } 
+        --size; // Уменьшаем размер 
+
+        // Проверяем, нужно ли уменьшить емкость
+        if (size < maxsize / 2 && maxsize > 1) { 
+            shrinkToFit(); // Уменьшаем емкость до необходимого размера
+        }
+    }
+    // Получение размера контейнера
+    int getSize() const {
+        return size; // Возвращаем текущее количество элементов
+    }
+
+    int getmaxsize() const {
+        return maxsize; // Возвращаем текущее количество элементов
+    }
+
+    // Вывод содержимого контейнера
+    void print() const {
+    for (int i = 0; i < size; ++i) {
+        std::cout << slot(i) << " ";
+    }
+    std::cout << std::endl;
+    }
+
+    // Оператор [] для доступа к элементам по индексу (новый)
+    int& operator[](int index) {
+        if (index < 0 || index >= size) {      
+            throw std::out_of_range("Индекс вне диапазона");
+        }
+        if (trace) {
+            trace->record(TraceOp::Index, index, 0);
+        }
+        return slot(index);// Возвращаем элемент по индексу
+    }
+
+    // Структура итератора для ConsistentContainer.
+    // Хранит индекс, а не указатель, чтобы читать из нужного буфера во время переноса.
+    // Чтение и обход ничего не переносят, поэтому ссылки живут до следующего push_back.
+    struct Iterator {
+        ConsistentContainer* owner;
+        int index;
+
+        // Конструктор
+        Iterator(ConsistentContainer* owner, int index) : owner(owner), index(index) {}
+
+        // Оператор разыменования
+        int& operator*() {
+            if (index < 0 || index >= owner->size) {
+                throw std::out_of_range("Индекс вне диапазона"); 
+            }
+            return owner->slot(index);
+        }
+        int& get() {
+            if (index < 0 || index >= owner->size) {
+                throw std::out_of_range("Индекс вне диапазона"); 
+            }
+            return owner->slot(index);
+        }
+
+        // Оператор сравнения (для проверки конца итерации)
+        bool operator!=(const Iterator& rvalue) {
+            return owner != rvalue.owner || index != rvalue.index;
+        }
+
+        // Перемещение итератора на следующий элемент
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+    };
+    // Возвращает итератор на начало контейнера
+    Iterator begin() {
+        return Iterator(this, 0);
+    }
+
+    // Возвращает итератор на конец контейнера
+    Iterator end() {
+        return Iterator(this, size);
+    }
+
+    // Деструктор
+    ~ConsistentContainer() {
+        releaseData();
+        releaseOld();
+    }
+};
+
+// Отсортированный последовательный контейнер (повторы допускаются).
+// Хранит элементы в ConsistentContainer по возрастанию; поиск позиции —
+// безветвленный двоичный поиск вместо линейного прохода.
+class SortedContainer {
+private:
+    ConsistentContainer items;
+    bool useEytzinger; // Проверять принадлежность по индексу в раскладке Эйтцингера
+    bool indexDirty; // Индекс устарел и будет перестроен при следующем поиске
+    // eytzinger.data[1..size]: дерево поиска в порядке обхода в ширину.
+    // Буфер выровнен по kAlignment, поэтому узлы [16k, 16k + 16) — одна строка кэша
+    ConsistentContainer eytzinger;
+
+    // Заполнение индекса: in-order обход неявного дерева раскладывает
+    // отсортированный массив по узлам 1, 2, 3, ...
+    int buildIndex(int i, int k) {
+        if (k <= items.size) {
+            i = buildIndex(i, 2 * k);
+            eytzinger.data[k] = items.data[i++];
+            i = buildIndex(i, 2 * k + 1);
+        }
+        return i;
+    }
+
+    void rebuildIndex() {
+        if (items.size == INT_MAX) {
+            throw std::length_error("Слишком много элементов для индекса Эйтцингера");
+        }
+        eytzinger.size = 0; // Старый индекс не копируется при расширении
+        if (eytzinger.maxsize < items.size + 1) {
+            eytzinger.reallocate(items.size + 1);
+        }
+        eytzinger.size = items.size + 1;
+        eytzinger.data[0] = 0;
+        buildIndex(0, 1);
+        indexDirty = false;
+    }
+
+public:
+    // Конструктор
+    SortedContainer() : useEytzinger(false), indexDirty(true) {}
+
+    // Перемещающий конструктор
+    SortedContainer(SortedContainer&& rvalue) noexcept
+    : items(std::move(rvalue.items)), useEytzinger(rvalue.useEytzinger), indexDirty(true) {
+        rvalue.indexDirty = true;
+    }
+
+    // Перемещающий оператор присваивания
+    SortedContainer& operator=(SortedContainer&& rvalue) noexcept {
+        if (this != &rvalue) {
+            items = std::move(rvalue.items);
+            useEytzinger = rvalue.useEytzinger;
+            indexDirty = true;
+            rvalue.indexDirty = true;
+        }
+        return *this;
+    }
+
+    // Включение индекса Эйтцингера для contains(): дерево поиска лежит в массиве
+    // по уровням, и первые шаги поиска попадают в одни и те же строки кэша
+    void setEytzingerIndex(bool enabled) {
+        useEytzinger = enabled;
+        if (!enabled) {
+            eytzinger = ConsistentContainer(); // Память индекса освобождается
+        }
+        indexDirty = true;
+    }
+
+    // Индекс первого элемента, не меньшего value (size, если такого нет).
+    // Безветвленный поиск: условие превращается в cmov, а не в переход.
+    int lower_bound(int value) const {
+        const int* base = items.data;
+        int n = items.size;
+        if (n == 0) {
+            return 0;
+        }
+        while (n > 1) {
+            int half = n / 2;
+            base = base[half - 1] < value ? base + half : base;
+            n -= half;
+        }
+        return static_cast<int>(base - items.data) + (*base < value);
+    }
+
+    // Индекс первого элемента, большего value
+    int upper_bound(int value) const {
+        const int* base = items.data;
+        int n = items.size;
+        if (n == 0) {
+            return 0;
+        }
+        while (n > 1) {
+            int half = n / 2;
+            base = base[half - 1] <= value ? base + half : base;
+            n -= half;
+        }
+        return static_cast<int>(base - items.data) + (*base <= value);
+    }
+
+    // Есть ли value в контейнере
+    bool contains(int value) {
+        if (!useEytzinger) {
+            int pos = lower_bound(value);
+            return pos < items.size && items.data[pos] == value;
+        }
+        if (indexDirty) {
+            rebuildIndex();
+        }
+        const int* tree = eytzinger.data;
+        std::size_t n = static_cast<std::size_t>(items.size);
+        std::size_t k = 1;
+        while (k <= n) {
+            if (16 * k <= n) {
+                LAB3_PREFETCH(tree + 16 * k); // Узлы на 4 уровня ниже — одна строка кэша
+            }
+            k = 2 * k + (tree[k] < value);
+        }
+        // Снимаем последние повороты вправо: остается узел нижней границы (0 — нет такого)
+        while (k & 1) {
+            k >>= 1;
+        }
+        k >>= 1;
+        return k != 0 && tree[k] == value;
+    }
+
+    // Запросы по диапазону значений везде берут полуинтервал [low, high).
+
+    // Границы индексов [first, second) элементов со значениями из [low, high)
+    std::pair<int, int> range(int low, int high) const {
+        int first = lower_bound(low);
+        int last = high <= low ? first : lower_bound(high);
+        return std::make_pair(first, last);
+    }
+
+    // Число элементов со значениями из [low, high)
+    int count_range(int low, int high) const {
+        std::pair<int, int> bounds = range(low, high);
+        return bounds.second - bounds.first;
+    }
+
+    // Вставка с сохранением порядка: поиск O(log n), сдвиг O(n)
+    void insert_sorted(int value) {
+        items.insert(upper_bound(value), value); // Повторы встают после равных
+        indexDirty = true;
+    }
+
+    // Удаление одного вхождения value, false если его нет
+    bool erase_value(int value) {
+        int pos = lower_bound(value);
+        if (pos == items.size || items.data[pos] != value) {
+            return false;
+        }
+        items.erase(pos);
+        indexDirty = true;
+        return true;
+    }
+
+    // Вставка пачки: пачка сортируется и сливается с буфером за один
+    // линейный проход с конца, вместо count отдельных сдвигов
+    void insert_batch(const int* values, int count) {
+        if (count <= 0) {
+            return;
+        }
+        if (count > INT_MAX - items.size) {
+            throw std::length_error("Слишком много элементов для SortedContainer");
+        }
+        std::vector<int> batch(values, values + count);
+        std::sort(batch.begin(), batch.end());
+        items.completeMigration();
+        int total = items.size + count;
+        if (total > items.maxsize) {
+            int grown = items.maxsize > INT_MAX / 3 * 2 ? INT_MAX : static_cast<int>(items.maxsize * 1.5);
+            items.reallocate(grown > total ? grown : total);
+        }
+        int* data = items.data;
+        int i = items.size - 1;
+        int j = count - 1;
+        for (int k = total - 1; j >= 0; --k) {
+            if (i >= 0 && data[i] > batch[j]) {
+                data[k] = data[i--];
+            } else {
+                data[k] = batch[j--];
+            }
+        }
+        items.size = total;
+        indexDirty = true;
+    }
+
+    // Получение размера контейнера
+    int getSize() const {
+        return items.size;
+    }
+
+    // Чтение элемента по индексу (запись сломала бы порядок)
+    int operator[](int index) const {
+        if (index < 0 || index >= items.size) {
+            throw std::out_of_range("Индекс вне диапазона");
+        }
+        return items.data[index];
+    }
+
+    // Вывод содержимого контейнера
+    void print() const {
+        items.print();
+    }
+};
+
+
+// Класс для спискового контейнера (связь через указатели)
+// Двусвязный список, где каждый элемент хранит ссылку на предыдущий и следующий
+class DoubleLinkedList {
+private:
+    struct Node {
+        int value;
+        Node* next;
+        Node* prev;
+
+        Node(int value) : value(value), next(nullptr), prev(nullptr) {}
+    };
+
+    Node* head;
+    Node* tail;
+    int size;
+    TraceRecorder* trace; // Запись операций в трассу, nullptr если не ведется
+    Node* block; // Непрерывный блок узлов после linearize(), иначе nullptr
+    int blockSize; // Сколько узлов в блоке
+    int blockLive; // Сколько узлов блока еще в списке
+
+    // Освобождение узла: узлы блока не удаляются по одному,
+    // блок освобождается целиком, когда из него уходит последний узел
+    void freeNode(Node* node) {
+        std::less<Node*> less;
+        if (block != nullptr && !less(node, block) && less(node, block + blockSize)) {
+            if (--blockLive == 0) {
+                ::operator delete(block);
+                block = nullptr;
+                blockSize = 0;
+            }
+        } else {
+            delete node;
+        }
+    }
+
+public:
+    // Конструктор
+    DoubleLinkedList()
+    : head(nullptr), tail(nullptr), size(0), trace(nullptr), block(nullptr), blockSize(0), blockLive(0) {}
+
+    // Деструктор
+    ~DoubleLinkedList() {
+        while (head != nullptr) {
+            Node* next = head->next;
+            freeNode(head);
+            head = next;
+        }
+    }
+
+    // Перемещающий конструктор
+    DoubleLinkedList(DoubleLinkedList&& rvalue) noexcept
+    : head(std::move(rvalue.head)), tail(std::move(rvalue.tail)), size(rvalue.size), trace(rvalue.trace),
+      block(rvalue.block), blockSize(rvalue.blockSize), blockLive(rvalue.blockLive) {
+        rvalue.head = nullptr;
+        rvalue.tail = nullptr;
+        rvalue.size = 0;
+        rvalue.trace = nullptr;
+        rvalue.block = nullptr;
+        rvalue.blockSize = 0;
+        rvalue.blockLive = 0;
+    }
+
+    // Перемещающий оператор присваивания
+    DoubleLinkedList& operator=(DoubleLinkedList&& rvalue) noexcept {
+        if (this != &rvalue) {
+        // Освобождение текущих ресурсов
+        while (head != nullptr) {
+            Node* next = head->next;
+            freeNode(head);
+            head = next;
+        }
+
+        head = rvalue.head;
+        tail = rvalue.tail;
+        size = rvalue.size;
+        trace = rvalue.trace;
+        block = rvalue.block;
+        blockSize = rvalue.blockSize;
+        blockLive = rvalue.blockLive;
+
+        rvalue.head = nullptr;
+        rvalue.tail = nullptr;
+        rvalue.size = 0;
+        rvalue.trace = nullptr;
+        rvalue.block = nullptr;
+        rvalue.blockSize = 0;
+        rvalue.blockLive = 0;
+        }
+        return *this;
+    }
+    
+    // Добавление элемента в конец
+    void push_back(int value) {
+        if (trace) {
+            trace->record(TraceOp::PushBack, 0, value);
+        }
+        Node* newNode = new Node(value);
+        if (head == nullptr) {
+            head = newNode;
+            tail = newNode;
+        } else {
+            tail->next = newNode;
+            newNode->prev = tail;
+            tail = newNode;
+        }
+        ++size;
+    }
+
+    // Добавление элемента в начало
+    void push_front(int value) {
+        if (trace) {
+            trace->record(TraceOp::PushFront, 0, value);
+        }
+        Node* newNode = new Node(value);
+        if (head == nullptr) {
+            head = newNode;
+            tail = newNode;
+        } else {
+            newNode->next = head;
+            head->prev = newNode;
+            head = newNode;
+        }
+        ++size;
+    }
+
+    // Добавление элемента по индексу
+    void insert(int index, int value) {
+        if (index < 0 || index > size) {
+            throw std::out_of_range("Индекс вне допустимого диапазона");
+        }
+        // Вставка на краях попадает в трассу как push_front/push_back
+        if (index == 0) {
+            push_front(value);
+            return;
+        } else if (index == size) {
+            push_back(value);
+            return;
+        }
+        if (trace) {
+            trace->record(TraceOp::Insert, index, value);
+        }
+
+        Node* newNode = new Node(value);
+        Node* current = head;
+        for (int i = 0; i < index; ++i) {
+            current = current->next;
+        }
+
+        newNode->next = current;
+        newNode->prev = current->prev;
+        current->prev->next = newNode;
+        current->prev = newNode;
+
+        ++size;
+    }
+
+    // Удаление элемента по индексу
+    void erase(int index) {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("Индекс вне допустимого диапазона");
+        }
+        if (trace) {
+            trace->record(TraceOp::Erase, index, 0);
+        }
+        Node* current = head;
+        for (int i = 0; i < index; ++i) {
+            current = current->next;
+        }
+
+        if (current->prev) {
+            current->prev->next = current->next;
+        } else {
+            head = current->next; // Удаление головного элемента
+        }
+
+        if (current->next) {
+            current->next->prev = current->prev;
+        } else {
+            tail = current->prev; // Удаление хвостового элемента
+        }
+
+        freeNode(current);
+        --size;
+    }
+
+    // Получение размера контейнера
+    int getSize() const {
+        return size;
+    }
+
+    // Подключение записи трассы (nullptr отключает запись).
+    // Текущее содержимое записывается как push_back.
+    void setTrace(TraceRecorder* recorder) {
+        trace = recorder;
+        for (Node* current = head; trace && current != nullptr; current = current->next) {
+            trace->record(TraceOp::PushBack, 0, current->value);
+        }
+    }
+
+    // Перекладывает все узлы в один непрерывный блок в порядке обхода.
+    // Значения и порядок сохраняются, старые узлы освобождаются.
+    // Указатели и итераторы на узлы после вызова недействительны.
+    void linearize() {
+        if (size == 0) {
+            return;
+        }
+        Node* newBlock = static_cast<Node*>(::operator new(sizeof(Node) * static_cast<std::size_t>(size)));
+        Node* current = head;
+        for (int i = 0; i < size; ++i) {
+            Node* node = new (&newBlock[i]) Node(current->value);
+            node->prev = i > 0 ? &newBlock[i - 1] : nullptr;
+            node->next = i + 1 < size ? &newBlock[i + 1] : nullptr;
+            Node* next = current->next;
+            freeNode(current);
+            current = next;
+        }
+        head = &newBlock[0];
+        tail = &newBlock[size - 1];
+        block = newBlock;
+        blockSize = size;
+        blockLive = size;
+    }
+
+    // Вывод содержимого контейнера
+    void print() const {
+        Node* current = head;
+        while (current != nullptr) {
+            std::cout << current->value << " ";
+            current = current->next;
+        }
+        std::cout << std::endl;
+    }
+
+    // Оператор [] для доступа к элементам по индексу
+    int& operator[](int index) {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("Индекс вне диапазона");
+        }
+        if (trace) {
+            trace->record(TraceOp::Index, index, 0);
+        }
+        Node* current = head;
+        for (int i = 0; i < index; ++i) {
+            current = current->next;
+        }
+        return current->value;
+    }
+    // Структура итератора для DoubleLinkedList
+    struct Iterator {
+        Node* ptr;
+
+        // Конструктор
+        Iterator(Node* ptr) : ptr(ptr) {}
+
+        // Оператор разыменования
+        int operator*() {
+            if (ptr == nullptr) {
+                throw std::out_of_range("Индекс вне диапазона");
+            }
+            return ptr->value;
+        }
+
+        // Оператор сравнения (для проверки конца итерации)
+        bool operator!=(const Iterator& rvalue) {
+            return ptr != rvalue.ptr;
+        }
+
+        // Перемещение итератора на следующий элемент
+        Iterator& operator++() {
+            ptr = ptr->next;
+            return *this;
+        }
+
+        int& get() {
+            if (ptr == nullptr) {
+                throw std::out_of_range("Индекс вне диапазона");
+            }
+            return ptr->value;
+        }
+    };
+
+    // Возвращает итератор на начало контейнера
+    Iterator begin() {
+        return Iterator(head);
+    }
+
+    // Возвращает итератор на конец контейнера
+    Iterator end() {
+        return Iterator(nullptr);
+    }
+};
+
+// Односвязный список, где каждый элемент хранит ссылку только на следующий
+class SinglyLinkedList {
+private:
+    struct Node {
+        int value;
+        Node* next;
+
+        Node(int value) : value(value), next(nullptr) {}
+    };
+
+    Node* head;
+    int size;
+    TraceRecorder* trace; // Запись операций в трассу, nullptr если не ведется
+    Node* block; // Непрерывный блок узлов после linearize(), иначе nullptr
+    int blockSize; // Сколько узлов в блоке
+    int blockLive; // Сколько узлов блока еще в списке
+
+    // Освобождение узла: узлы блока не удаляются по одному,
+    // блок освобождается целиком, когда из него уходит последний узел
+    void freeNode(Node* node) {
+        std::less<Node*> less;
+        if (block != nullptr && !less(node, block) && less(node, block + blockSize)) {
+            if (--blockLive == 0) {
+                ::operator delete(block);
+                block = nullptr;
+                blockSize = 0;
+            }
+        } else {
+            delete node;
+        }
+    }
+
+public:
+    // Конструктор
+    SinglyLinkedList() : head(nullptr), size(0), trace(nullptr), block(nullptr), blockSize(0), blockLive(0) {}
+
+    // Деструктор
+    ~SinglyLinkedList() {
+        while (head != nullptr) {
+            Node* next = head->next;
+            freeNode(head);
+            head = next;
+        }
+    }
+
+    // Перемещающий конструктор
+    SinglyLinkedList(SinglyLinkedList&& rvalue) noexcept:  head(rvalue.head), size(rvalue.size), trace(rvalue.trace),
+      block(rvalue.block), blockSize(rvalue.blockSize), blockLive(rvalue.blockLive) {
+        rvalue.head = nullptr;
+        rvalue.size = 0;
+        rvalue.trace = nullptr;
+        rvalue.block = nullptr;
+        rvalue.blockSize = 0;
+        rvalue.blockLive = 0;
+    }
+
+    // Перемещающий оператор присваивания
+    SinglyLinkedList& operator=(SinglyLinkedList&& rvalue) noexcept {
+        if (this != &rvalue) {
+            while (head != nullptr) {
+                Node* temp = head;
+                head = head->next;
+                freeNode(temp);
+            }
+            head = rvalue.head;
+            size = rvalue.size;
+            trace = rvalue.trace;
+            block = rvalue.block;
+            blockSize = rvalue.blockSize;
+            blockLive = rvalue.blockLive;
+
+            rvalue.head = nullptr;
+            rvalue.size = 0;
+            rvalue.trace = nullptr;
+            rvalue.block = nullptr;
+            rvalue.blockSize = 0;
+            rvalue.blockLive = 0;
+        }
+        return *this;
+    }    
+
+    // Добавление элемента в конец
+    void push_back(int value) {
+        if (trace) {
+            trace->record(TraceOp::PushBack, 0, value);
+        }
+        Node* newNode = new Node(value);
+        if (head == nullptr) {
+            head = newNode;
+        } else {
+            Node* current = head;
+            while (current->next != nullptr) {
+                current = current->next;
+            }
+            current->next = newNode;
+        }
+        ++size;
+    }
+
+    // Добавление элемента в начало
+    void push_front(int value) {
+        if (trace) {
+            trace->record(TraceOp::PushFront, 0, value);
+        }
+        Node* newNode = new Node(value);
+        newNode->next = head;
+        head = newNode;
+        ++size;
+    }
+
+
+    // Метод для вставки элемента по индексу
+    void insert(int index, int value) {
+        if (index < 0 || index > size) {
+            throw std::out_of_range("Индекс вне допустимого диапазона");
+        }
+        // Вставка на краях попадает в трассу как push_front/push_back
+        if (index == 0) {
+            push_front(value);
+            return;
+        }
+        if (index == size) {
+            push_back(value);
+            return;
+        }
+        if (trace) {
+            trace->record(TraceOp::Insert, index, value);
+        }
+
+        Node* newNode = new Node(value);
+        Node* current = head;
+        for (int i = 0; i < index - 1; ++i) {
+            current = current->next;
+        }
+        newNode->next = current->next;
+        current->next = newNode;
+        ++size;
+    }
+
+    // Удаление элемента по индексу
+    void erase(int index) {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("Индекс вне допустимого диапазона");
+        }
+        if (trace) {
+            trace->record(TraceOp::Erase, index, 0);
+        }
+        Node* current = head;
+        if (index == 0) {
+            head = current->next;
+            freeNode(current);
+        } else {
+            Node* prev = nullptr;
+            for (int i = 0; i < index; ++i) {
+                prev = current;
+                current = current->next;
+            }
+            prev->next = current->next;
+            freeNode(current);
+        }
+        --size;
+    }
+
+    // Получение размера контейнера
+    int getSize() const {
+        return size;
+    }
+
+    // Подключение записи трассы (nullptr отключает запись).
+    // Текущее содержимое записывается как push_back.
+    void setTrace(TraceRecorder* recorder) {
+        trace = recorder;
+        for (Node* current = head; trace && current != nullptr; current = current->next) {
+            trace->record(TraceOp::PushBack, 0, current->value);
+        }
+    }
+
+    // Перекладывает все узлы в один непрерывный блок в порядке обхода.
+    // Значения и порядок сохраняются, старые узлы освобождаются.
+    // Указатели и итераторы на узлы после вызова недействительны.
+    void linearize() {
+        if (size == 0) {
+            return;
+        }
+        Node* newBlock = static_cast<Node*>(::operator new(sizeof(Node) * static_cast<std::size_t>(size)));
+        Node* current = head;
+        for (int i = 0; i < size; ++i) {
+            Node* node = new (&newBlock[i]) Node(current->value);
+            node->next = i + 1 < size ? &newBlock[i + 1] : nullptr;
+            Node* next = current->next;
+            freeNode(current);
+            current = next;
+        }
+        head = &newBlock[0];
+        block = newBlock;
+        blockSize = size;
+        blockLive = size;
+    }
+
+    // Вывод содержимого контейнера
+    void print() const {
+        Node* current = head;
+        while (current != nullptr) {
+            std::cout << current->value << " ";
+            current = current->next;
+        }
+        std::cout << std::endl;
+    }
+
+    // Оператор [] для доступа к элементам по индексу
+    int& operator[](int index) {
+        if (index < 0 || index >= size) {
+            throw std::out_of_range("Индекс вне диапазона");
+        }
+        if (trace) {
+            trace->record(TraceOp::Index, index, 0);
+        }
+        Node* current = head;
+        for (int i = 0; i < index; ++i) {
+            current = current->next;
+        }
+        return current->value;
+    }
+
+    // Структура итератора для SinglyLinkedList
+    struct Iterator {
+        Node* ptr;
+
+        // Конструктор
+        Iterator(Node* ptr) : ptr(ptr) {}
+
+        // Оператор разыменования
+        int operator*() {
+            if (ptr == nullptr) {
+                throw std::out_of_range("Индекс вне диапазона");
+            }            
+            return ptr->value;
+        }
+
+        // Оператор сравнения (для проверки конца итерации)
+        bool operator!=(const Iterator& rvalue) {
+            return ptr != rvalue.ptr;
+        }
+
+        // Перемещение итератора на следующий элемент
+        Iterator& operator++() {
+            ptr = ptr->next;
+            return *this;
+        }
+        int& get() {
+            if (ptr == nullptr) {
+                throw std::out_of_range("Индекс вне диапазона");
+            }
+            return ptr->value;
+        }
+    };
+    // Возвращает итератор на начало контейнера
+    Iterator begin() {
+        return Iterator(head);
+    }
+
+    // Возвращает итератор на конец контейнера
+    Iterator end() {
+        return Iterator(nullptr);
+    }
+};
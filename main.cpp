@@ -1,587 +1,24 @@
 #include <iostream>
-#include <utility>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
-//Последовательный контейнер 
-struct ConsistentContainer {
-    int* data; // Указатель на массив 
-    int size; // Текущее количество элементов
-    int maxsize; // Максимальный размер массива
+#include "containers.h"
 
-    ConsistentContainer() : data(nullptr), size(0), maxsize(0) {}
-    
-    // Перемещающий конструктор
-    ConsistentContainer(ConsistentContainer&& rvalue) noexcept
-    : data(std::move(rvalue.data)), size(rvalue.size), maxsize(rvalue.maxsize) {
-        rvalue.data = nullptr; // Освобождаем указатель у другого объекта
-        rvalue.size = 0;
-        rvalue.maxsize = 0;
-    }
-
-    // Перемещающий оператор присваивания
-    ConsistentContainer& operator=(ConsistentContainer&& rvalue) noexcept {
-        if (this != &rvalue) { 
-        data = rvalue.data;
-        size = rvalue.size;
-        maxsize = rvalue.maxsize;
-        rvalue.data = nullptr; // Освобождаем указатель у другого объекта
-        rvalue.size = 0;
-        rvalue.maxsize = 0;
-        }
-        return *this;
-    }
-
-    // Функция для увеличения емкости
-    void moresize() {
-        maxsize = maxsize == 0 ? 1 : static_cast<int>(maxsize * 1.5); 
-        int* newData = new int[maxsize];
-        for (int i = 0; i < size; ++i) {
-            newData[i] = data[i]; // Копируем старые данные в новую память
-        }
-        delete[] data; 
-        data = newData; // Перенаправляем указатель на новую память
-    }
-
-    // Функция для уменьшения емкости до фактического размера
-    void shrinkToFit() {
-        int* newData = new int[size]; // Выделяем новую память по размеру фактических данных
-        for (int i = 0; i < size; ++i) {
-            newData[i] = data[i]; // Копируем данные
-        }
-        delete[] data; 
-        data = newData; 
-        maxsize = size; // Обновляем емкость
-    }
-
-    // Добавление элемента в конец
-    void push_back(int value) {
-        if (size == maxsize) {
-            moresize(); // Изменяем размер, если емкость заполнена
-        }
-        data[size++] = value; // Добавляем элемент и увеличиваем размер
-    }
-    // Добавление элемента в начало
-    void push_front(int value) {
-        if (size == maxsize) {
-            moresize(); // Изменяем размер, если емкость заполнена
-        }
-        // Сдвигаем все элементы на один вправо
-        for (int i = size; i > 0; --i) {
-            data[i] = data[i - 1];
-        }
-        data[0] = value; // Вставляем новый элемент в начало
-        ++size;
-    }
-
-    // Добавление элемента в указанный индекс
-    void insert(int index, int value) {
-        if (index < 0 || index > size) {
-            throw std::out_of_range("Индекс вне диапазона"); // Исключение для недопустимого индекса
-        }
-        if (size == maxsize) {
-            moresize(); // Изменяем размер, если емкость заполнена
-        }
-        // Сдвигаем элементы вправо, начиная с указанного индекса
-        for (int i = size; i > index; --i) {
-            data[i] = data[i - 1];
-        }
-        data[index] = value; // Вставляем значение в указанный индекс
-        ++size;
-    }
-
-    // Удаление элемента по индексу 
-    void erase(int index) { 
-        if (index < 0 || index >= size) { 
-            throw std::out_of_range("Индекс вне диапазона"); // Исключение для недопустимого индекса 
-        } 
-        for (int i = index; i < size - 1; ++i) { 
-            data[i] = data[i + 1]; // Сдвинаем элементы влево 
-        } 
-        --size; // Уменьшаем размер 
-
-        // Проверяем, нужно ли уменьшить емкость
-        if (size < maxsize / 2 && maxsize > 1) { 
-            shrinkToFit(); // Уменьшаем емкость до необходимого размера
-        }
-    }
-    // Получение размера контейнера
-    int getSize() const {
-        return size; // Возвращаем текущее количество элементов
-    }
-
-    int getmaxsize() const {
-        return maxsize; // Возвращаем текущее количество элементов
-    }
-
-    // Вывод содержимого контейнера
-    void print() const {
-    for (int i = 0; i < size; ++i) {
-        std::cout << data[i] << " ";
-    }
-    std::cout << std::endl;
-    }
-
-    // Оператор [] для доступа к элементам по индексу (новый)
-    int& operator[](int index) {
-        if (index < 0 || index >= size) {      
-            throw std::out_of_range("Индекс вне диапазона");
-        }
-        return data[index];// Возвращаем элемент по индексу
-    }
-
-    // Структура итератора для ConsistentContainer
-    struct Iterator {
-        int* ptr;
-
-        // Конструктор
-        Iterator(int* ptr) : ptr(ptr) {}
-
-        // Оператор разыменования
-        int& operator*() {
-            if (ptr==nullptr) {
-                throw std::out_of_range("Индекс вне диапазона"); 
-            }
-            return *ptr;
-        }
-        int& get() {
-            if (ptr == nullptr) {
-                throw std::out_of_range("Индекс вне диапазона"); 
-            }
-            return *ptr;
-        }
-
-        // Оператор сравнения (для проверки конца итерации)
-        bool operator!=(const Iterator& rvalue) {
-            return ptr != rvalue.ptr;
-        }
-
-        // Перемещение итератора на следующий элемент
-        Iterator& operator++() {
-            ptr++;
-            return *this;
-        }
-
-    };
-    // Возвращает итератор на начало контейнера
-    Iterator begin() {
-        return Iterator(data);
-    }
-
-    // Возвращает итератор на конец контейнера
-    Iterator end() {
-        return Iterator(data + size);
-    }
-
-    // Деструктор
-    ~ConsistentContainer() {
-    //delete[] data;
-    }
-};
-
-
-// Класс для спискового контейнера (связь через указатели)
-// Двусвязный список, где каждый элемент хранит ссылку на предыдущий и следующий
-class DoubleLinkedList {
-private:
-    struct Node {
-        int value;
-        Node* next;
-        Node* prev;
-
-        Node(int value) : value(value), next(nullptr), prev(nullptr) {}
-    };
-
-    Node* head;
-    Node* tail;
-    int size;
-
-public:
-    // Конструктор
-    DoubleLinkedList() : head(nullptr), tail(nullptr), size(0) {}
-
-    // Деструктор
-    ~DoubleLinkedList() {
-        while (head != nullptr) {
-            Node* next = head->next;
-            delete head;
-            head = next;
-        }
-    }
-
-    // Перемещающий конструктор
-    DoubleLinkedList(DoubleLinkedList&& rvalue) noexcept
-    : head(std::move(rvalue.head)), tail(std::move(rvalue.tail)), size(rvalue.size){
-        rvalue.head = nullptr;
-        rvalue.tail = nullptr;
-        rvalue.size = 0;
-    }
-
-    // Перемещающий оператор присваивания
-    DoubleLinkedList& operator=(DoubleLinkedList&& rvalue) noexcept {
-        if (this != &rvalue) {
-        // Освобождение текущих ресурсов
-        while (head != nullptr) {
-            Node* next = head->next;
-            delete head;
-            head = next;
-        }
-
-        head = rvalue.head;
-        tail = rvalue.tail;
-        size = rvalue.size;
-
-        rvalue.head = nullptr;
-        rvalue.tail = nullptr;
-        rvalue.size = 0;
-        }
-        return *this;
-    }
-    
-    // Добавление элемента в конец
-    void push_back(int value) {
-        Node* newNode = new Node(value);
-        if (head == nullptr) {
-            head = newNode;
-            tail = newNode;
-        } else {
-            tail->next = newNode;
-            newNode->prev = tail;
-            tail = newNode;
-        }
-        ++size;
-    }
-
-    // Добавление элемента в начало
-    void push_front(int value) {
-        Node* newNode = new Node(value);
-        if (head == nullptr) {
-            head = newNode;
-            tail = newNode;
-        } else {
-            newNode->next = head;
-            head->prev = newNode;
-            head = newNode;
-        }
-        ++size;
-    }
-
-    // Добавление элемента по индексу
-    void insert(int index, int value) {
-        if (index < 0 || index > size) {
-            throw std::out_of_range("Индекс вне допустимого диапазона");
-        }
-        if (index == 0) {
-            push_front(value);
-            return;
-        } else if (index == size) {
-            push_back(value);
-            return;
-        }
-
-        Node* newNode = new Node(value);
-        Node* current = head;
-        for (int i = 0; i < index; ++i) {
-            current = current->next;
-        }
-
-        newNode->next = current;
-        newNode->prev = current->prev;
-        current->prev->next = newNode;
-        current->prev = newNode;
-
-        ++size;
-    }
-
-    // Удаление элемента по индексу
-    void erase(int index) {
-        if (index < 0 || index >= size) {
-            throw std::out_of_range("Индекс вне допустимого диапазона");
-        }
-        Node* current = head;
-        for (int i = 0; i < index; ++i) {
-            current = current->next;
-        }
-
-        if (current->prev) {
-            current->prev->next = current->next;
-        } else {
-            head = current->next; // Удаление головного элемента
-        }
-
-        if (current->next) {
-            current->next->prev = current->prev;
-        } else {
-            tail = current->prev; // Удаление хвостового элемента
-        }
-
-        delete current;
-        --size;
-    }
-
-    // Получение размера контейнера
-    int getSize() const {
-        return size;
-    }
-
-    // Вывод содержимого контейнера
-    void print() const {
-        Node* current = head;
-        while (current != nullptr) {
-            std::cout << current->value << " ";
-            current = current->next;
-        }
-        std::cout << std::endl;
-    }
-
-    // Оператор [] для доступа к элементам по индексу
-    int& operator[](int index) {
-        if (index < 0 || index >= size) {
-            throw std::out_of_range("Индекс вне диапазона");
-        }
-        Node* current = head;
-        for (int i = 0; i < index; ++i) {
-            current = current->next;
-        }
-        return current->value;
-    }
-    // Структура итератора для DoubleLinkedList
-    struct Iterator {
-        Node* ptr;
-
-        // Конструктор
-        Iterator(Node* ptr) : ptr(ptr) {}
-
-        // Оператор разыменования
-        int operator*() {
-            if (ptr == nullptr) {
-                throw std::out_of_range("Индекс вне диапазона");
-            }
-            return ptr->value;
-        }
-
-        // Оператор сравнения (для проверки конца итерации)
-        bool operator!=(const Iterator& rvalue) {
-            return ptr != rvalue.ptr;
-        }
-
-        // Перемещение итератора на следующий элемент
-        Iterator& operator++() {
-            ptr = ptr->next;
-            return *this;
-        }
-
-        int& get() {
-            if (ptr == nullptr) {
-                throw std::out_of_range("Индекс вне диапазона");
-            }
-            return ptr->value;
-        }
-    };
-
-    // Возвращает итератор на начало контейнера
-    Iterator begin() {
-        return Iterator(head);
-    }
-
-    // Возвращает итератор на конец контейнера
-    Iterator end() {
-        return Iterator(nullptr);
-    }
-};
-
-// Односвязный список, где каждый элемент хранит ссылку только на следующий
-class SinglyLinkedList {
-private:
-    struct Node {
-        int value;
-        Node* next;
-
-        Node(int value) : value(value), next(nullptr) {}
-    };
-
-    Node* head;
-    int size;
-
-public:
-    // Конструктор
-    SinglyLinkedList() : head(nullptr), size(0) {}
-
-    // Деструктор
-    ~SinglyLinkedList() {
-        while (head != nullptr) {
-            Node* next = head->next;
-            delete head;
-            head = next;
-        }
-    }
-
-    // Перемещающий конструктор
-    SinglyLinkedList(SinglyLinkedList&& rvalue) noexcept:  head(rvalue.head), size(rvalue.size) {
-        rvalue.head = nullptr;
-        rvalue.size = 0;
-    }
-
-    // Перемещающий оператор присваивания
-    SinglyLinkedList& operator=(SinglyLinkedList&& rvalue) noexcept {
-        if (this != &rvalue) {
-            while (head != nullptr) {
-                Node* temp = head;
-                head = head->next;
-                delete temp;
-            }
-            head = rvalue.head;
-            size = rvalue.size;
-
-            rvalue.head = nullptr;
-            rvalue.size = 0;
-        }
-        return *this;
-    }    
-
-    // Добавление элемента в конец
-    void push_back(int value) {
-        Node* newNode = new Node(value);
-        if (head == nullptr) {
-            head = newNode;
-        } else {
-            Node* current = head;
-            while (current->next != nullptr) {
-                current = current->next;
-            }
-            current->next = newNode;
-        }
-        ++size;
-    }
-
-    // Добавление элемента в начало
-    void push_front(int value) {
-        Node* newNode = new Node(value);
-        newNode->next = head;
-        head = newNode;
-        ++size;
-    }
-
-
-    // Метод для вставки элемента по индексу
-    void insert(int index, int value) {
-        if (index < 0 || index > size) {
-            throw std::out_of_range("Индекс вне допустимого диапазона");
-        }
-        if (index == 0) {
-            push_front(value);
-            return;
-        }
-        if (index == size) {
-            push_back(value);
-            return;
-        }
-
-        Node* newNode = new Node(value);
-        Node* current = head;
-        for (int i = 0; i < index - 1; ++i) {
-            current = current->next;
-        }
-        newNode->next = current->next;
-        current->next = newNode;
-        ++size;
-    }
-
-    // Удаление элемента по индексу
-    void erase(int index) {
-        if (index < 0 || index >= size) {
-            throw std::out_of_range("Индекс вне допустимого диапазона");
-        }
-        Node* current = head;
-        if (index == 0) {
-            head = current->next;
-            delete current;
-        } else {
-            Node* prev = nullptr;
-            for (int i = 0; i < index; ++i) {
-                prev = current;
-                current = current->next;
-            }
-            prev->next = current->next;
-            delete current;
-        }
-        --size;
-    }
-
-    // Получение размера контейнера
-    int getSize() const {
-        return size;
-    }
-
-    // Вывод содержимого контейнера
-    void print() const {
-        Node* current = head;
-        while (current != nullptr) {
-            std::cout << current->value << " ";
-            current = current->next;
-        }
-        std::cout << std::endl;
-    }
-
-    // Оператор [] для доступа к элементам по индексу
-    int& operator[](int index) {
-        if (index < 0 || index >= size) {
-            throw std::out_of_range("Индекс вне диапазона");
-        }
-        Node* current = head;
-        for (int i = 0; i < index; ++i) {
-            current = current->next;
-        }
-        return current->value;
-    }
-
-    // Структура итератора для SinglyLinkedList
-    struct Iterator {
-        Node* ptr;
-
-        // Конструктор
-        Iterator(Node* ptr) : ptr(ptr) {}
-
-        // Оператор разыменования
-        int operator*() {
-            if (ptr == nullptr) {
-                throw std::out_of_range("Индекс вне диапазона");
-            }            
-            return ptr->value;
-        }
-
-        // Оператор сравнения (для проверки конца итерации)
-        bool operator!=(const Iterator& rvalue) {
-            return ptr != rvalue.ptr;
-        }
-
-        // Перемещение итератора на следующий элемент
-        Iterator& operator++() {
-            ptr = ptr->next;
-            return *this;
-        }
-        int& get() {
-            if (ptr == nullptr) {
-                throw std::out_of_range("Индекс вне диапазона");
-            }
-            return ptr->value;
-        }
-    };
-    // Возвращает итератор на начало контейнера
-    Iterator begin() {
-        return Iterator(head);
-    }
-
-    // Возвращает итератор на конец контейнера
-    Iterator end() {
-        return Iterator(nullptr);
-    }
-};
-
-int main() {
+int main(int argc, char** argv) {
 // Создание объектов контейнеров
     ConsistentContainer vec;
     DoubleLinkedList Double_lst;
     SinglyLinkedList Singl_lst;
 
+    // Если передан путь к файлу, операции над vec записываются в трассу для lab3_replay
+    std::unique_ptr<TraceRecorder> recorder;
+    if (argc > 1) {
+        recorder.reset(new TraceRecorder(argv[1], TraceKind::Consistent));
+        vec.setTrace(recorder.get());
+    }
+
     // Тестирование контейнера ConsistentContainer
     std::cout << "ConsistentContainer:" << std::endl;
 
@@ -771,4 +208,105 @@ int main() {
          	std::cout << "Ошибка: conte существует!" << std::endl;
      	}
      	std::cout << std::endl;
-}}
\ No newline at end of file
+   }
+
+   // Демонстрация роста большого буфера через mmap/mremap
+   {
+       std::cout << "Рост большого буфера ConsistentContainer:\n";
+       ConsistentContainer big;
+       big.setHugeThreshold(1u << 20); // 1 МБ
+       const char* names[] = {"Heap", "Mmap", "Mremap"};
+       int path = -1;
+       for (int i = 0; i < (1 << 20); ++i) {
+           big.push_back(i);
+           int current = static_cast<int>(big.getAllocPath());
+           if (current != path) {
+               path = current;
+               std::cout << "Размер " << big.getSize() << ", емкость " << big.getmaxsize()
+                         << ": " << names[path] << std::endl;
+           }
+       }
+       std::cout << "Выравнивание по 64 байтам: "
+                 << (reinterpret_cast<std::uintptr_t>(big.data) % ConsistentContainer::kAlignment == 0 ? "да" : "нет")
+                 << std::endl;
+       std::cout << std::endl;
+   }
+
+   // Демонстрация постепенного роста: худшее время одного push_back
+   {
+       std::cout << "Постепенный рост ConsistentContainer:\n";
+       for (int mode = 0; mode < 2; ++mode) {
+           ConsistentContainer grow;
+           grow.setHugeThreshold(static_cast<std::size_t>(-1)); // Только куча, без mremap
+           grow.setIncrementalGrowth(mode == 1);
+           long long worst = 0;
+           for (int i = 0; i < (1 << 22); ++i) {
+               auto t0 = std::chrono::steady_clock::now();
+               grow.push_back(i);
+               auto t1 = std::chrono::steady_clock::now();
+               long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+               if (ns > worst) {
+                   worst = ns;
+               }
+           }
+           std::cout << (mode == 1 ? "Постепенный" : "Обычный") << " рост, худший push_back: "
+                     << worst / 1000 << " мкс" << std::endl;
+       }
+
+       // insert и push_front в заполненный контейнер расширяют его сразу, без отложенного переноса
+       ConsistentContainer full;
+       full.setIncrementalGrowth(true);
+       for (int i = 0; i < 4; ++i) {
+           full.push_back(i);
+       }
+       full.insert(1, 42);
+       full.push_front(-1);
+       std::cout << "insert(1, 42) и push_front(-1) в заполненный контейнер: ";
+       full.print();
+       std::cout << std::endl;
+   }
+
+   // Демонстрация отсортированного контейнера
+   {
+       std::cout << "SortedContainer:\n";
+       SortedContainer sorted;
+       int batch[] = {42, 7, 19, 3, 25, 7};
+       sorted.insert_batch(batch, 6);
+       sorted.insert_sorted(10);
+       std::cout << "Контейнер: ";
+       sorted.print();
+       sorted.erase_value(7);
+       std::cout << "Удаление одного 7: ";
+       sorted.print();
+       std::pair<int, int> bounds = sorted.range(5, 25);
+       std::cout << "Элементов в [5, 25): " << bounds.second - bounds.first
+                 << ", lower_bound(20) = " << sorted.lower_bound(20) << std::endl;
+
+       // Проверки принадлежности с индексом Эйтцингера и без него
+       const int count = 1 << 20;
+       std::vector<int> values(count);
+       for (int i = 0; i < count; ++i) {
+           values[i] = static_cast<int>((i * 2654435761u) >> 2); // Перемешанные значения
+       }
+       SortedContainer big;
+       auto t0 = std::chrono::steady_clock::now();
+       big.insert_batch(values.data(), count);
+       auto t1 = std::chrono::steady_clock::now();
+       std::cout << "insert_batch " << count << " элементов: "
+                 << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count() << " мс" << std::endl;
+       for (int mode = 0; mode < 2; ++mode) {
+           big.setEytzingerIndex(mode == 1);
+           big.contains(0); // Построение индекса не входит в замер
+           int found = 0;
+           t0 = std::chrono::steady_clock::now();
+           for (int i = 0; i < count; ++i) {
+               found += big.contains(values[(i * 7919u) & (count - 1)] + (i & 1)); // Половина запросов — промахи
+           }
+           t1 = std::chrono::steady_clock::now();
+           std::cout << (mode == 1 ? "contains (Эйтцингер): " : "contains (двоичный поиск): ")
+                     << std::chrono::duration_cast<std::chrono::milliseconds>(t1 - t0).count()
+                     << " мс, найдено " << found << std::endl;
+       }
+       std::cout << std::endl;
+   }
+}
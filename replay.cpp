@@ -0,0 +1,238 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#define LAB3_HAVE_RUSAGE 1
+#endif
+
+#include "containers.h"
+
+// Воспроизведение трассы, записанной TraceRecorder, на выбранном контейнере.
+// Для каждой операции строится гистограмма задержек. Эталон (std::vector или
+// std::list) прогоняется по той же трассе отдельным проходом уже после замеров,
+// чтобы не влиять на память и кэш, и затем сравнивается с контейнером.
+
+static const char* kOpNames[] = {"push_back", "push_front", "insert", "erase", "operator[]"};
+
+// Гистограмма задержек: корзина k хранит вызовы длительностью [2^k, 2^(k+1)) нс
+struct LatencyHistogram {
+    static const int kBuckets = 40;
+    long long buckets[kBuckets];
+    long long count;
+    long long totalNs;
+    long long maxNs;
+
+    LatencyHistogram() : count(0), totalNs(0), maxNs(0) {
+        for (int i = 0; i < kBuckets; ++i) {
+            buckets[i] = 0;
+        }
+    }
+
+    void add(long long ns) {
+        int k = 0;
+        while (k + 1 < kBuckets && (1LL << (k + 1)) <= ns) {
+            ++k;
+        }
+        ++buckets[k];
+        ++count;
+        totalNs += ns;
+        if (ns > maxNs) {
+            maxNs = ns;
+        }
+    }
+
+    // Верхняя граница корзины, в которую попадает перцентиль p
+    long long percentile(double p) const {
+        long long target = static_cast<long long>(p * count);
+        long long seen = 0;
+        for (int k = 0; k < kBuckets; ++k) {
+            seen += buckets[k];
+            if (seen > target) {
+                return 1LL << (k + 1);
+            }
+        }
+        return maxNs;
+    }
+
+    void print(const char* name) const {
+        std::cout << name << ": вызовов " << count
+                  << ", среднее " << (count ? totalNs / count : 0) << " нс"
+                  << ", p50 < " << percentile(0.5) << " нс"
+                  << ", p99 < " << percentile(0.99) << " нс"
+                  << ", p99.99 < " << percentile(0.9999) << " нс"
+                  << ", max " << maxNs << " нс" << std::endl;
+        for (int k = 0; k < kBuckets; ++k) {
+            if (buckets[k] != 0) {
+                std::cout << "    [" << (k == 0 ? 0 : 1LL << k) << ", " << (1LL << (k + 1))
+                          << ") нс: " << buckets[k] << std::endl;
+            }
+        }
+    }
+};
+
+// Пиковый RSS процесса в килобайтах, -1 если недоступно
+static long peakRssKb() {
+#ifdef LAB3_HAVE_RUSAGE
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return usage.ru_maxrss / 1024; // На macOS значение в байтах
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return -1;
+}
+
+// Проверка, что индекс операции допустим для контейнера текущего размера
+static void checkIndex(const TraceRecord& rec, std::size_t size) {
+    std::size_t index = static_cast<std::size_t>(rec.index);
+    bool bad = false;
+    if (rec.op == TraceOp::Insert) {
+        bad = rec.index < 0 || index > size;
+    } else if (rec.op == TraceOp::Erase || rec.op == TraceOp::Index) {
+        bad = rec.index < 0 || index >= size;
+    }
+    if (bad) {
+        throw std::runtime_error("Трасса не согласована: индекс вне диапазона");
+    }
+}
+
+// Эталон для ConsistentContainer
+static void applyReference(std::vector<int>& ref, const TraceRecord& rec) {
+    checkIndex(rec, ref.size());
+    switch (rec.op) {
+    case TraceOp::PushBack: ref.push_back(rec.value); break;
+    case TraceOp::PushFront: ref.insert(ref.begin(), rec.value); break;
+    case TraceOp::Insert: ref.insert(ref.begin() + rec.index, rec.value); break;
+    case TraceOp::Erase: ref.erase(ref.begin() + rec.index); break;
+    case TraceOp::Index: break;
+    }
+}
+
+// Эталон для списков
+static void applyReference(std::list<int>& ref, const TraceRecord& rec) {
+    checkIndex(rec, ref.size());
+    switch (rec.op) {
+    case TraceOp::PushBack: ref.push_back(rec.value); break;
+    case TraceOp::PushFront: ref.push_front(rec.value); break;
+    case TraceOp::Insert: ref.insert(std::next(ref.begin(), rec.index), rec.value); break;
+    case TraceOp::Erase: ref.erase(std::next(ref.begin(), rec.index)); break;
+    case TraceOp::Index: break;
+    }
+}
+
+// Воспроизведение трассы на контейнере с замером задержек и сверкой с эталоном.
+// rssBaseline — пиковый RSS до загрузки трассы.
+template <class Container, class Reference>
+static int replay(TraceReader& reader, const char* name, long rssBaseline) {
+    Container container;
+    LatencyHistogram histograms[5];
+    volatile int sink = 0; // Не дает компилятору выбросить чтения operator[]
+    long rssBefore = peakRssKb(); // Уже с загруженной трассой
+    long long ops = 0;
+
+    // Проход 1: только проверяемый контейнер
+    auto started = std::chrono::steady_clock::now();
+    TraceRecord rec;
+    while (reader.next(rec)) {
+        auto t0 = std::chrono::steady_clock::now();
+        try {
+            switch (rec.op) {
+            case TraceOp::PushBack: container.push_back(rec.value); break;
+            case TraceOp::PushFront: container.push_front(rec.value); break;
+            case TraceOp::Insert: container.insert(rec.index, rec.value); break;
+            case TraceOp::Erase: container.erase(rec.index); break;
+            case TraceOp::Index: sink = container[rec.index]; break;
+            }
+        } catch (const std::out_of_range&) {
+            throw std::runtime_error("Трасса не согласована: индекс вне диапазона");
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        histograms[static_cast<int>(rec.op) - 1].add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        ++ops;
+    }
+    auto finished = std::chrono::steady_clock::now();
+    long rssAfter = peakRssKb();
+    (void)sink;
+
+    std::cout << "Контейнер: " << name << ", операций: " << ops << ", время: "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(finished - started).count()
+              << " мс" << std::endl;
+    for (int i = 0; i < 5; ++i) {
+        if (histograms[i].count != 0) {
+            histograms[i].print(kOpNames[i]);
+        }
+    }
+    if (rssAfter >= 0) {
+        std::cout << "Пиковая память процесса: " << rssAfter << " КБ (трасса "
+                  << rssBefore - rssBaseline << " КБ, контейнер "
+                  << rssAfter - rssBefore << " КБ)" << std::endl;
+    } else {
+        std::cout << "Пиковая память процесса: недоступно на этой платформе" << std::endl;
+    }
+
+    // Проход 2: эталон, после всех замеров
+    Reference reference;
+    reader.rewind();
+    while (reader.next(rec)) {
+        applyReference(reference, rec);
+    }
+
+    // Сверка итогового содержимого с эталоном
+    bool same = container.getSize() == static_cast<int>(reference.size());
+    auto expected = reference.begin();
+    for (auto it = container.begin(); same && it != container.end(); ++it, ++expected) {
+        same = it.get() == *expected;
+    }
+    if (!same) {
+        std::cout << "ОШИБКА: содержимое расходится с эталоном" << std::endl;
+        return 1;
+    }
+    std::cout << "Содержимое совпадает с эталоном (" << reference.size() << " элементов)" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Использование: lab3_replay <трасса> [consistent|double|singly]" << std::endl;
+        return 2;
+    }
+    try {
+        long rssBaseline = peakRssKb();
+        TraceReader reader(argv[1]);
+        TraceKind kind = reader.getKind(); // По умолчанию контейнер, на котором писали трассу
+        if (argc == 3) {
+            if (std::strcmp(argv[2], "consistent") == 0) {
+                kind = TraceKind::Consistent;
+            } else if (std::strcmp(argv[2], "double") == 0) {
+                kind = TraceKind::DoubleLinked;
+            } else if (std::strcmp(argv[2], "singly") == 0) {
+                kind = TraceKind::SinglyLinked;
+            } else {
+                std::cerr << "Неизвестный контейнер: " << argv[2] << std::endl;
+                return 2;
+            }
+        }
+        switch (kind) {
+        case TraceKind::Consistent:
+            return replay<ConsistentContainer, std::vector<int>>(reader, "ConsistentContainer", rssBaseline);
+        case TraceKind::DoubleLinked:
+            return replay<DoubleLinkedList, std::list<int>>(reader, "DoubleLinkedList", rssBaseline);
+        case TraceKind::SinglyLinked:
+            return replay<SinglyLinkedList, std::list<int>>(reader, "SinglyLinkedList", rssBaseline);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+    return 2;
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Формат трассы: заголовок "L3TR", версия, вид контейнера,
+// затем записи: код операции (1 байт) и аргументы в виде varint.
+// Значения кодируются zigzag, чтобы отрицательные числа занимали мало места.
+
+// Операции, которые попадают в трассу
+enum class TraceOp : std::uint8_t {
+    PushBack = 1,  // value
+    PushFront = 2, // value
+    Insert = 3,    // index, value
+    Erase = 4,     // index
+    Index = 5      // index (operator[])
+};
+
+// Вид контейнера, для которого записана трасса
+enum class TraceKind : std::uint8_t {
+    Consistent = 1,
+    DoubleLinked = 2,
+    SinglyLinked = 3
+};
+
+// Одна операция из трассы
+struct TraceRecord {
+    TraceOp op;
+    int index;
+    int value;
+};
+
+static const char kTraceMagic[4] = {'L', '3', 'T', 'R'};
+static const std::uint8_t kTraceVersion = 1;
+
+// Запись операций контейнера в бинарный файл.
+// Один recorder обслуживает один контейнер.
+class TraceRecorder {
+private:
+    std::ofstream out;
+    std::vector<unsigned char> buffer; // Записи копятся здесь и сбрасываются блоками
+
+    void putVarint(std::uint32_t v) {
+        while (v >= 0x80) {
+            buffer.push_back(static_cast<unsigned char>(v | 0x80));
+            v >>= 7;
+        }
+        buffer.push_back(static_cast<unsigned char>(v));
+    }
+
+public:
+    // Конструктор, открывает файл и пишет заголовок
+    TraceRecorder(const std::string& path, TraceKind kind)
+    : out(path, std::ios::binary | std::ios::trunc) {
+        if (!out) {
+            throw std::runtime_error("Не удалось открыть файл трассы: " + path);
+        }
+        out.write(kTraceMagic, sizeof(kTraceMagic));
+        out.put(static_cast<char>(kTraceVersion));
+        out.put(static_cast<char>(kind));
+        buffer.reserve(1 << 16);
+    }
+
+    // Деструктор
+    ~TraceRecorder() {
+        flush();
+    }
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    // Добавление операции в трассу
+    void record(TraceOp op, int index, int value) {
+        buffer.push_back(static_cast<unsigned char>(op));
+        if (op == TraceOp::Insert || op == TraceOp::Erase || op == TraceOp::Index) {
+            putVarint(static_cast<std::uint32_t>(index));
+        }
+        if (op == TraceOp::PushBack || op == TraceOp::PushFront || op == TraceOp::Insert) {
+            std::uint32_t u = static_cast<std::uint32_t>(value);
+            putVarint((u << 1) ^ (value < 0 ? 0xFFFFFFFFu : 0u)); // zigzag
+        }
+        if (buffer.size() >= (1 << 16) - 16) {
+            flush();
+        }
+    }
+
+    // Сброс накопленных записей в файл
+    void flush() {
+        if (!buffer.empty()) {
+            out.write(reinterpret_cast<const char*>(buffer.data()),
+                      static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+        out.flush();
+    }
+};
+
+// Чтение трассы, записанной TraceRecorder
+class TraceReader {
+private:
+    std::vector<unsigned char> bytes;
+    std::size_t pos;
+    TraceKind kind;
+
+    std::uint32_t getVarint() {
+        std::uint32_t v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (pos >= bytes.size()) {
+                throw std::runtime_error("Трасса обрезана");
+            }
+            unsigned char b = bytes[pos++];
+            v |= static_cast<std::uint32_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) {
+                return v;
+            }
+        }
+        throw std::runtime_error("Некорректный varint в трассе");
+    }
+
+public:
+    // Конструктор, читает файл целиком и проверяет заголовок
+    explicit TraceReader(const std::string& path) : pos(0), kind(TraceKind::Consistent) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw std::runtime_error("Не удалось открыть файл трассы: " + path);
+        }
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (bytes.size() < 6 || std::string(bytes.begin(), bytes.begin() + 4) != std::string(kTraceMagic, 4)) {
+            throw std::runtime_error("Файл не является трассой lab3: " + path);
+        }
+        if (bytes[4] != kTraceVersion) {
+            throw std::runtime_error("Неподдерживаемая версия трассы");
+        }
+        if (bytes[5] < 1 || bytes[5] > 3) {
+            throw std::runtime_error("Неизвестный вид контейнера в трассе");
+        }
+        kind = static_cast<TraceKind>(bytes[5]);
+        pos = 6;
+    }
+
+    TraceKind getKind() const {
+        return kind;
+    }
+
+    // Возврат к первой операции для повторного прохода
+    void rewind() {
+        pos = 6;
+    }
+
+    // Чтение следующей операции, false в конце трассы
+    bool next(TraceRecord& rec) {
+        if (pos >= bytes.size()) {
+            return false;
+        }
+        unsigned char op = bytes[pos++];
+        if (op < 1 || op > 5) {
+            throw std::runtime_error("Неизвестная операция в трассе");
+        }
+        rec.op = static_cast<TraceOp>(op);
+        rec.index = 0;
+        rec.value = 0;
+        if (rec.op == TraceOp::Insert || rec.op == TraceOp::Erase || rec.op == TraceOp::Index) {
+            rec.index = static_cast<int>(getVarint());
+        }
+        if (rec.op == TraceOp::PushBack || rec.op == TraceOp::PushFront || rec.op == TraceOp::Insert) {
+            std::uint32_t u = getVarint();
+            rec.value = static_cast<int>((u >> 1) ^ (0u - (u & 1))); // zigzag
+        }
+        return true;
+    }
+};